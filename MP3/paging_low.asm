@@ -29,4 +29,62 @@ _write_cr3:
 	mov eax, [ebp+8]
 	mov cr3, eax
 	pop ebp
-	retn
\ No newline at end of file
+	retn
+
+global _read_cr4
+_read_cr4:
+	mov eax, cr4
+	retn
+
+global _write_cr4
+_write_cr4:
+	push ebp
+	mov ebp, esp
+	mov eax, [ebp+8]
+	mov cr4, eax
+	pop ebp
+	retn
+
+global _invlpg
+_invlpg:
+	push ebp
+	mov ebp, esp
+	mov eax, [ebp+8]
+	invlpg [eax]
+	pop ebp
+	retn
+
+global _invlpg_range
+_invlpg_range:
+	push ebp
+	mov ebp, esp
+	mov eax, [ebp+8]        ; logical address of the first page
+	mov ecx, [ebp+12]       ; number of pages
+	test ecx, ecx
+	jz .done
+.next:
+	invlpg [eax]
+	add eax, 4096
+	dec ecx
+	jnz .next
+.done:
+	pop ebp
+	retn
+
+global _flush_tlb
+_flush_tlb:
+	mov eax, cr3
+	mov cr3, eax
+	retn
+
+global _read_cpuid_edx
+_read_cpuid_edx:
+	push ebp
+	mov ebp, esp
+	push ebx                ; cpuid clobbers ebx, which the caller expects kept
+	mov eax, [ebp+8]
+	cpuid
+	mov eax, edx
+	pop ebx
+	pop ebp
+	retn
@@ -0,0 +1,101 @@
+; File: smp_low.asm
+;
+; Startup code of the application processors (APs), i.e. of all CPUs but
+; the boot CPU.
+;
+; An AP starts in real mode, at the start of the page given by the
+; startup IPI. CPU::start_processors() copies the trampoline below, from
+; _ap_trampoline to _ap_trampoline_end, to that page (TRAMPOLINE_ADDRESS).
+; The trampoline loads a GDT of its own, switches to protected mode and
+; jumps into the kernel proper. There, each AP takes a number and the
+; stack that the boot CPU set aside for it, takes over the kernel GDT, the
+; IDT and the page directory of the boot CPU, turns on paging, and calls
+; ap_main() with its number.
+
+TRAMPOLINE_ADDRESS equ 0x8000
+
+global _ap_trampoline
+global _ap_trampoline_end
+global _ap_next
+global _ap_max
+global _ap_stacks
+global _ap_cr3
+global _ap_cr4
+extern _gdt_flush
+extern _idt_load
+extern _ap_main
+
+section .text
+
+; ----------------------------------------------------------------------
+; The trampoline. It runs at TRAMPOLINE_ADDRESS, so everything in it is
+; addressed relative to that.
+; ----------------------------------------------------------------------
+[BITS 16]
+_ap_trampoline:
+	cli
+	cld
+	xor ax, ax
+	mov ds, ax
+	lgdt [TRAMPOLINE_ADDRESS + (trampoline_gdt_ptr - _ap_trampoline)]
+	mov eax, cr0
+	or eax, 1		; PE: protected mode, no paging yet
+	mov cr0, eax
+	jmp dword 0x08:ap_protected_mode
+
+ALIGN 8
+trampoline_gdt:
+	dq 0
+	dq 0x00CF9A000000FFFF	; 0x08: code, flat 4 GB, like the kernel's
+	dq 0x00CF92000000FFFF	; 0x10: data, flat 4 GB
+trampoline_gdt_ptr:
+	dw trampoline_gdt_ptr - trampoline_gdt - 1
+	dd TRAMPOLINE_ADDRESS + (trampoline_gdt - _ap_trampoline)
+_ap_trampoline_end:
+
+; ----------------------------------------------------------------------
+; Back in the kernel image, in protected mode.
+; ----------------------------------------------------------------------
+[BITS 32]
+ap_protected_mode:
+	mov ax, 0x10
+	mov ds, ax
+	mov es, ax
+	mov fs, ax
+	mov gs, ax
+	mov ss, ax
+
+	mov eax, 1
+	lock xadd [_ap_next], eax	; eax = number of this AP, from 1
+	cmp eax, [_ap_max]
+	ja ap_halt		; no stack was set aside for us
+	mov esp, [_ap_stacks + 4 * eax]
+	push eax
+
+	call _gdt_flush
+	call _idt_load
+
+	mov eax, [_ap_cr4]
+	mov cr4, eax
+	mov eax, [_ap_cr3]
+	mov cr3, eax
+	mov eax, cr0
+	or eax, 0x80010000	; PG, and WP as on the boot CPU
+	mov cr0, eax
+
+	call _ap_main		; number still on the stack
+ap_halt:
+	cli
+	hlt
+	jmp ap_halt
+
+; ----------------------------------------------------------------------
+; Filled in by the boot CPU before it sends the startup IPIs.
+; ----------------------------------------------------------------------
+section .data
+
+_ap_next:	dd 1		; number of the next AP to start
+_ap_max:	dd 0		; highest AP number with a stack
+_ap_stacks:	times 8 dd 0	; top of stack of each AP, by number
+_ap_cr3:	dd 0
+_ap_cr4:	dd 0
@@ -12,6 +12,8 @@
 global start
 start:
     mov esp, _sys_stack     ; This points the stack to our new stack area
+    mov [_multiboot_magic], eax ; Saved for MemoryMap::init()
+    mov [_multiboot_info], ebx
     jmp stublet
 
 ; This part MUST be 4byte aligned, so we solve that issue using 'ALIGN 4'
@@ -108,3 +110,12 @@ SECTION .bss
     resb 8192               ; This reserves 8KBytes of memory here
 _sys_stack:
 
+; What the boot loader passed in EAX and EBX: the multiboot magic number,
+; and the physical address of the multiboot information structure.
+global _multiboot_magic
+global _multiboot_info
+_multiboot_magic:
+    resd 1
+_multiboot_info:
+    resd 1
+
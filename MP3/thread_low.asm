@@ -0,0 +1,31 @@
+; File: thread_low.asm
+;
+; Low-level thread switching.
+
+; ----------------------------------------------------------------------
+; switch_context(unsigned long * _save_esp, unsigned long _esp)
+;
+; Saves the callee-saved registers and EFLAGS of the running thread on
+; its stack, stores its stack pointer in *_save_esp, and picks up the
+; thread whose stack pointer is _esp where it left off: either in a call
+; of switch_context(), or with the frame that Thread::Thread() built.
+;
+; ----------------------------------------------------------------------
+global _switch_context
+; this function is exported.
+_switch_context:
+	mov eax, [esp + 4]	; where to save our stack pointer
+	mov edx, [esp + 8]	; stack pointer of the next thread
+	pushfd
+	push ebp
+	push ebx
+	push esi
+	push edi
+	mov [eax], esp
+	mov esp, edx
+	pop edi
+	pop esi
+	pop ebx
+	pop ebp
+	popfd
+	ret